@@ -0,0 +1,696 @@
+// Validation daemon for Boolean expressions.
+// Loads the Boolean expression CFG once, then listens on a Unix domain socket
+// and validates expressions sent by clients, so that process start-up and
+// grammar construction are no longer paid on every validation.
+//
+// Protocol (all integers are big-endian):
+// - Request:  [u32 length][length bytes of expression text, no '\0']
+// - Response: [u32 length = 4][u8 status][u8 reserved][u16 position]
+//   - status: one of the STATUS_* values below.
+//   - position: the number of tokens for STATUS_OK, the byte offset of the
+//   offending character for STATUS_TOKEN_ERROR, and the index of the
+//   offending token for STATUS_PARSE_ERROR.
+// Clients may pipeline any number of requests on one connection. Responses are
+// always sent back in request order.
+#define _GNU_SOURCE
+#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define MAX_RHS 10     // Maximum number of symbols on the RHS of a production rule
+#define MAX_SYMBOLS 10 // Maximum number of symbols in the CFG
+#define MAX_RULES 10   // Maximum number of rules in the CFG
+
+#define DEFAULT_SOCKET_PATH "/tmp/cfg_daemon.sock"
+#define MAX_CONNECTIONS 1024     // Maximum number of simultaneous clients
+#define MAX_EVENTS 64            // Maximum number of events per epoll_wait()
+#define MAX_BATCH 256            // Maximum number of requests per batch
+#define MAX_EXPR_LENGTH 4096     // Maximum length of an expression in bytes
+#define IN_BUFFER_SIZE (1 << 16) // Per-connection receive buffer size
+#define OUT_BUFFER_SIZE (1 << 16) // Per-connection send buffer size
+#define HEADER_SIZE 4            // Size of the length prefix of a frame
+#define RESPONSE_SIZE 8          // Size of a full response frame
+
+// Response status codes
+#define STATUS_OK 0          // Expression is a sentence of the CFG
+#define STATUS_TOKEN_ERROR 1 // Expression contains an unexpected character
+#define STATUS_PARSE_ERROR 2 // Tokens cannot be derived from the start symbol
+#define STATUS_BAD_FRAME 3   // Length prefix is 0 or exceeds MAX_EXPR_LENGTH
+#define STATUS_PENDING 255   // Internal: request not yet processed
+
+// Struct for CFG symbols.
+// - symbol: Stores symbol as a string (e.g., "true", "false", "AND")
+// - is_terminal: An int, which indicates whether the symbol is terminal (0 =
+// false, 1 = true)
+// - is_start: An int, which indicates whether the symbol is a start symbol (0
+// = false, 1 = true)
+typedef struct {
+  char *symbol;
+  int is_terminal;
+  int is_start;
+} CFGSymbol;
+
+// Struct for production rules
+// - lhs: Left-hand side of the production rule (always a non-terminal)
+// - rhs: Right-hand side of the production rule, with size MAX_RHS.
+// - rhs_length: Number of symbols on the RHS
+typedef struct {
+  CFGSymbol lhs;
+  CFGSymbol rhs[MAX_RHS];
+  int rhs_length;
+} CFGProductionRule;
+
+// Struct for CFG
+// - symbols: Array of all CFG symbols, with size MAX_SYMBOLS.
+// - startSymbol: The start symbol of the CFG
+// - rules: Array of production rules, with size MAX_RULES.
+// - symbol_count: Number of symbols in the CFG
+// - rule_count: Number of rules in the CFG
+typedef struct {
+  CFGSymbol symbols[MAX_SYMBOLS];
+  CFGSymbol startSymbol;
+  CFGProductionRule rules[MAX_RULES];
+  int symbol_count;
+  int rule_count;
+} CFG;
+
+// Struct for the grammar loaded by the daemon.
+// - cfg: The Boolean expression CFG.
+// - terminals: Pointers to the terminal symbols in cfg.symbols, used by the
+// tokenizer.
+// - terminal_lengths: Precomputed strlen() of each terminal.
+// - terminal_count: Number of terminals.
+// - and_id, or_id, ...: Indices of the terminals in terminals. Tokens are
+// stored as these indices, so the parser compares small ints, not strings.
+typedef struct {
+  CFG cfg;
+  const CFGSymbol *terminals[MAX_SYMBOLS];
+  int terminal_lengths[MAX_SYMBOLS];
+  int terminal_count;
+  int and_id;
+  int or_id;
+  int true_id;
+  int false_id;
+  int lparen_id;
+  int rparen_id;
+} Grammar;
+
+// Struct for a client connection.
+// - fd: The connected socket.
+// - in: Received bytes; unconsumed data is in [in_start, in_length).
+// - out: Encoded responses; unsent data is in [out_start, out_length).
+// - queued: Number of requests of this connection in the current batch.
+// - eof: The client has finished sending.
+// - closing: A protocol error occurred; close once the output is flushed.
+// - dead: The socket failed; close immediately.
+// - touched: The connection is in the current iteration's touched list.
+typedef struct {
+  int fd;
+  unsigned char in[IN_BUFFER_SIZE];
+  int in_start;
+  int in_length;
+  unsigned char out[OUT_BUFFER_SIZE];
+  int out_start;
+  int out_length;
+  int queued;
+  int eof;
+  int closing;
+  int dead;
+  int touched;
+} Connection;
+
+// Struct for a request in a batch.
+// - conn: The connection the response is sent to.
+// - expr: The expression text, pointing into conn->in.
+// - length: The length of expr in bytes.
+// - tokens: The tokens of expr, as terminal indices of the grammar. Every
+// token is at least one byte long, so MAX_EXPR_LENGTH tokens always fit.
+// - token_count: Number of tokens.
+// - status: One of the STATUS_* values.
+// - position: Reported back to the client, see the protocol description.
+typedef struct {
+  Connection *conn;
+  const char *expr;
+  int length;
+  uint8_t tokens[MAX_EXPR_LENGTH];
+  int token_count;
+  int status;
+  int position;
+} Request;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+// Generic function to initialize a CFGSymbol
+void init_CFGSymbol(CFGSymbol *symbol, char *text, int is_terminal,
+                    int is_start) {
+  symbol->symbol = text;
+  symbol->is_terminal = is_terminal;
+  symbol->is_start = is_start;
+}
+
+// Function to add a production rule lhs --> rhs to the CFG
+void addProductionRule(CFG *cfg, CFGSymbol lhs, CFGSymbol rhs[],
+                       int rhs_length) {
+  CFGProductionRule *rule = &cfg->rules[cfg->rule_count++];
+  rule->lhs = lhs;
+  for (int i = 0; i < rhs_length; ++i) {
+    rule->rhs[i] = rhs[i];
+  }
+  rule->rhs_length = rhs_length;
+}
+
+// Function to find a terminal of the grammar by its text (only used at load
+// time). Returns its index in g->terminals, or -1 if not found.
+int findTerminal(const Grammar *g, const char *text) {
+  for (int i = 0; i < g->terminal_count; ++i) {
+    if (!strcmp(g->terminals[i]->symbol, text)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Function to load the Boolean expression CFG, done once at start-up.
+// (1): S -> B
+// (2): B -> B OR T
+// (3): B -> T
+// (4): T -> T AND F
+// (5): T -> F
+// (6): F -> ( B )
+// (7): F -> true
+// (8): F -> false
+void loadGrammar(Grammar *g) {
+  CFG *cfg = &g->cfg;
+  CFGSymbol S, B, T, F, AND, OR, LPAREN, RPAREN, TRUE, FALSE;
+
+  init_CFGSymbol(&S, "S", 0, 1);
+  init_CFGSymbol(&B, "B", 0, 0);
+  init_CFGSymbol(&T, "T", 0, 0);
+  init_CFGSymbol(&F, "F", 0, 0);
+  init_CFGSymbol(&AND, "AND", 1, 0);
+  init_CFGSymbol(&OR, "OR", 1, 0);
+  init_CFGSymbol(&LPAREN, "(", 1, 0);
+  init_CFGSymbol(&RPAREN, ")", 1, 0);
+  init_CFGSymbol(&TRUE, "true", 1, 0);
+  init_CFGSymbol(&FALSE, "false", 1, 0);
+
+  CFGSymbol symbols[] = {S, B, T, F, AND, OR, LPAREN, RPAREN, TRUE, FALSE};
+  cfg->symbol_count = sizeof(symbols) / sizeof(symbols[0]);
+  memcpy(cfg->symbols, symbols, sizeof(symbols));
+  cfg->startSymbol = S;
+
+  cfg->rule_count = 0;
+  addProductionRule(cfg, S, (CFGSymbol[]){B}, 1);
+  addProductionRule(cfg, B, (CFGSymbol[]){B, OR, T}, 3);
+  addProductionRule(cfg, B, (CFGSymbol[]){T}, 1);
+  addProductionRule(cfg, T, (CFGSymbol[]){T, AND, F}, 3);
+  addProductionRule(cfg, T, (CFGSymbol[]){F}, 1);
+  addProductionRule(cfg, F, (CFGSymbol[]){LPAREN, B, RPAREN}, 3);
+  addProductionRule(cfg, F, (CFGSymbol[]){TRUE}, 1);
+  addProductionRule(cfg, F, (CFGSymbol[]){FALSE}, 1);
+
+  g->terminal_count = 0;
+  for (int i = 0; i < cfg->symbol_count; ++i) {
+    if (cfg->symbols[i].is_terminal) {
+      g->terminals[g->terminal_count] = &cfg->symbols[i];
+      g->terminal_lengths[g->terminal_count] = strlen(cfg->symbols[i].symbol);
+      ++g->terminal_count;
+    }
+  }
+
+  g->and_id = findTerminal(g, "AND");
+  g->or_id = findTerminal(g, "OR");
+  g->true_id = findTerminal(g, "true");
+  g->false_id = findTerminal(g, "false");
+  g->lparen_id = findTerminal(g, "(");
+  g->rparen_id = findTerminal(g, ")");
+}
+
+// Tokenizer function, using maximal munch over the terminals of the grammar.
+// Unlike tokenizeBooleanExpression() in Tokenizer.c, the input is not
+// '\0'-terminated and errors are reported through the request instead of
+// printed.
+void tokenizeRequest(const Grammar *g, Request *req) {
+  int i = 0;
+
+  req->token_count = 0;
+  while (i < req->length) {
+    // Skip whitespace, like tokenizeBooleanExpression()
+    if (isspace((unsigned char)req->expr[i])) {
+      ++i;
+      continue;
+    }
+
+    // Find the longest terminal matching at position i
+    int best = -1;
+    int best_length = 0;
+    for (int t = 0; t < g->terminal_count; ++t) {
+      int len = g->terminal_lengths[t];
+      if (len > best_length && len <= req->length - i &&
+          !memcmp(req->expr + i, g->terminals[t]->symbol, len)) {
+        best = t;
+        best_length = len;
+      }
+    }
+
+    if (best < 0) {
+      req->status = STATUS_TOKEN_ERROR;
+      req->position = i;
+      return;
+    }
+    req->tokens[req->token_count++] = best;
+    i += best_length;
+  }
+}
+
+// Recursive descent parser for the Boolean expression CFG. The left-recursive
+// rules (2) and (4) are applied as loops.
+// - Each function returns the index of the first token it did not consume, or
+// -1 on error, in which case *error_position holds the offending token index.
+int parseB(const Grammar *g, const Request *req, int pos, int *error_position);
+
+// F -> ( B ) | true | false
+int parseF(const Grammar *g, const Request *req, int pos,
+           int *error_position) {
+  if (pos >= req->token_count) {
+    *error_position = pos;
+    return -1;
+  }
+  int tok = req->tokens[pos];
+  if (tok == g->true_id || tok == g->false_id) {
+    return pos + 1;
+  }
+  if (tok == g->lparen_id) {
+    pos = parseB(g, req, pos + 1, error_position);
+    if (pos < 0) {
+      return -1;
+    }
+    if (pos >= req->token_count || req->tokens[pos] != g->rparen_id) {
+      *error_position = pos;
+      return -1;
+    }
+    return pos + 1;
+  }
+  *error_position = pos;
+  return -1;
+}
+
+// T -> T AND F | F
+int parseT(const Grammar *g, const Request *req, int pos,
+           int *error_position) {
+  pos = parseF(g, req, pos, error_position);
+  while (pos >= 0 && pos < req->token_count &&
+         req->tokens[pos] == g->and_id) {
+    pos = parseF(g, req, pos + 1, error_position);
+  }
+  return pos;
+}
+
+// B -> B OR T | T
+int parseB(const Grammar *g, const Request *req, int pos,
+           int *error_position) {
+  pos = parseT(g, req, pos, error_position);
+  while (pos >= 0 && pos < req->token_count && req->tokens[pos] == g->or_id) {
+    pos = parseT(g, req, pos + 1, error_position);
+  }
+  return pos;
+}
+
+// S -> B, and all tokens must be consumed
+void parseRequest(const Grammar *g, Request *req) {
+  int error_position = 0;
+  int pos = parseB(g, req, 0, &error_position);
+
+  if (pos < 0) {
+    req->status = STATUS_PARSE_ERROR;
+    req->position = error_position;
+  } else if (pos != req->token_count) {
+    req->status = STATUS_PARSE_ERROR;
+    req->position = pos;
+  } else {
+    req->status = STATUS_OK;
+    req->position = req->token_count;
+  }
+}
+
+// Helpers for big-endian integers
+uint32_t readU32(const unsigned char *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+void writeU32(unsigned char *p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+// Function to append a response frame to the connection's send buffer.
+// Space is reserved when the request is extracted, so this cannot overflow.
+void appendResponse(Connection *conn, int status, int position) {
+  unsigned char *p;
+
+  if (conn->out_start > 0 && conn->out_start == conn->out_length) {
+    conn->out_start = conn->out_length = 0;
+  }
+  if (conn->out_length + RESPONSE_SIZE > OUT_BUFFER_SIZE) {
+    memmove(conn->out, conn->out + conn->out_start,
+            conn->out_length - conn->out_start);
+    conn->out_length -= conn->out_start;
+    conn->out_start = 0;
+  }
+
+  p = conn->out + conn->out_length;
+  writeU32(p, RESPONSE_SIZE - HEADER_SIZE);
+  p[4] = status;
+  p[5] = 0;
+  p[6] = (position >> 8) & 0xff;
+  p[7] = position & 0xff;
+  conn->out_length += RESPONSE_SIZE;
+}
+
+// Function to process a batch of requests.
+// Requests go through the tokenizer together, then through the parser
+// together, and finally the responses are encoded in arrival order.
+void runBatch(const Grammar *g, Request *batch, int count) {
+  for (int i = 0; i < count; ++i) {
+    if (batch[i].status == STATUS_PENDING) {
+      tokenizeRequest(g, &batch[i]);
+    }
+  }
+
+  for (int i = 0; i < count; ++i) {
+    if (batch[i].status == STATUS_PENDING) {
+      parseRequest(g, &batch[i]);
+    }
+  }
+
+  for (int i = 0; i < count; ++i) {
+    appendResponse(batch[i].conn, batch[i].status, batch[i].position);
+    --batch[i].conn->queued;
+  }
+}
+
+// Function to check whether the send buffer has room for one more response,
+// counting the responses already reserved in the current batch.
+int hasResponseRoom(const Connection *conn) {
+  int pending = conn->out_length - conn->out_start;
+  return pending + (conn->queued + 1) * RESPONSE_SIZE <= OUT_BUFFER_SIZE;
+}
+
+// Function to check whether a complete frame is waiting in the receive buffer
+int hasCompleteFrame(const Connection *conn) {
+  int available = conn->in_length - conn->in_start;
+  if (available < HEADER_SIZE) {
+    return 0;
+  }
+  uint32_t length = readU32(conn->in + conn->in_start);
+  return length == 0 || length > MAX_EXPR_LENGTH ||
+         available >= HEADER_SIZE + (int)length;
+}
+
+// Function to read everything currently available on the socket
+void readConnection(Connection *conn) {
+  // The requests of the previous batch have been answered, so the consumed
+  // part of the buffer can be dropped.
+  if (conn->in_start > 0) {
+    memmove(conn->in, conn->in + conn->in_start,
+            conn->in_length - conn->in_start);
+    conn->in_length -= conn->in_start;
+    conn->in_start = 0;
+  }
+
+  while (conn->in_length < IN_BUFFER_SIZE) {
+    ssize_t n = read(conn->fd, conn->in + conn->in_length,
+                     IN_BUFFER_SIZE - conn->in_length);
+    if (n > 0) {
+      conn->in_length += n;
+    } else if (n == 0) {
+      conn->eof = 1;
+      return;
+    } else if (errno == EINTR) {
+      continue;
+    } else {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        conn->dead = 1;
+      }
+      return;
+    }
+  }
+}
+
+// Function to move the complete frames of a connection into the batch.
+// Runs the batch whenever it is full.
+void extractFrames(const Grammar *g, Connection *conn, Request *batch,
+                   int *batch_count) {
+  while (!conn->closing && !conn->dead && hasCompleteFrame(conn) &&
+         hasResponseRoom(conn)) {
+    if (*batch_count == MAX_BATCH) {
+      runBatch(g, batch, *batch_count);
+      *batch_count = 0;
+    }
+
+    Request *req = &batch[(*batch_count)++];
+    uint32_t length = readU32(conn->in + conn->in_start);
+    req->conn = conn;
+    ++conn->queued;
+
+    if (length == 0 || length > MAX_EXPR_LENGTH) {
+      // The stream cannot be resynchronized; answer and close.
+      req->expr = NULL;
+      req->length = 0;
+      req->status = STATUS_BAD_FRAME;
+      req->position = 0;
+      conn->closing = 1;
+      return;
+    }
+
+    req->expr = (const char *)conn->in + conn->in_start + HEADER_SIZE;
+    req->length = length;
+    req->status = STATUS_PENDING;
+    conn->in_start += HEADER_SIZE + length;
+  }
+}
+
+// Function to send as much of the send buffer as the socket accepts
+void flushConnection(Connection *conn) {
+  while (conn->out_start < conn->out_length) {
+    ssize_t n = send(conn->fd, conn->out + conn->out_start,
+                     conn->out_length - conn->out_start, MSG_NOSIGNAL);
+    if (n > 0) {
+      conn->out_start += n;
+    } else if (n < 0 && errno == EINTR) {
+      continue;
+    } else {
+      if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+        conn->dead = 1;
+      }
+      return;
+    }
+  }
+  conn->out_start = conn->out_length = 0;
+}
+
+// Function to close a connection and release it
+void closeConnection(int epfd, Connection *conn, int *connection_count) {
+  epoll_ctl(epfd, EPOLL_CTL_DEL, conn->fd, NULL);
+  close(conn->fd);
+  free(conn);
+  --*connection_count;
+}
+
+// Function to update the epoll interest of a connection after a batch.
+// - Readable: only while more input is accepted and responses fit.
+// - Writable: while responses are unsent, or while buffered frames wait for
+// send buffer space.
+// Closes the connection when there is nothing left to do.
+void updateConnection(int epfd, Connection *conn, int *connection_count) {
+  struct epoll_event ev;
+
+  if (!conn->dead) {
+    flushConnection(conn);
+  }
+  if (conn->dead) {
+    closeConnection(epfd, conn, connection_count);
+    return;
+  }
+
+  int want_in = !conn->eof && !conn->closing && hasResponseRoom(conn);
+  int want_out = conn->out_start < conn->out_length ||
+                 (!conn->closing && hasCompleteFrame(conn));
+
+  if (!want_in && !want_out) {
+    closeConnection(epfd, conn, connection_count);
+    return;
+  }
+
+  ev.events = (want_in ? EPOLLIN : 0) | (want_out ? EPOLLOUT : 0);
+  ev.data.ptr = conn;
+  if (epoll_ctl(epfd, EPOLL_CTL_MOD, conn->fd, &ev) < 0) {
+    closeConnection(epfd, conn, connection_count);
+  }
+}
+
+// Function to accept all pending connections
+void acceptConnections(int epfd, int listen_fd, int *connection_count) {
+  struct epoll_event ev;
+
+  for (;;) {
+    int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        perror("[ERROR] accept4");
+      }
+      return;
+    }
+    if (*connection_count >= MAX_CONNECTIONS) {
+      close(fd);
+      continue;
+    }
+
+    Connection *conn = calloc(1, sizeof(Connection));
+    if (conn == NULL) {
+      close(fd);
+      continue;
+    }
+    conn->fd = fd;
+    ev.events = EPOLLIN;
+    ev.data.ptr = conn;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+      close(fd);
+      free(conn);
+      continue;
+    }
+    ++*connection_count;
+  }
+}
+
+// Function to create the listening socket
+int openListener(const char *path) {
+  struct sockaddr_un addr;
+
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    printf("[ERROR] Socket path too long: %s\n", path);
+    return -1;
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    perror("[ERROR] socket");
+    return -1;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  unlink(path);
+
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(fd, SOMAXCONN) < 0) {
+    perror("[ERROR] bind/listen");
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+void handleStopSignal(int sig) {
+  (void)sig;
+  stop_requested = 1;
+}
+
+// Main function: ./daemon [socket_path]
+int main(int argc, char **argv) {
+  const char *path = argc > 1 ? argv[1] : DEFAULT_SOCKET_PATH;
+  static Grammar grammar;
+  static Request batch[MAX_BATCH];
+  struct epoll_event events[MAX_EVENTS];
+  Connection *touched[MAX_EVENTS];
+  struct epoll_event ev;
+  struct sigaction sa;
+  int connection_count = 0;
+
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = handleStopSignal;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  // --- Load the CFG once ---
+  loadGrammar(&grammar);
+
+  int listen_fd = openListener(path);
+  if (listen_fd < 0) {
+    return 1;
+  }
+
+  int epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (epfd < 0) {
+    perror("[ERROR] epoll_create1");
+    return 1;
+  }
+  ev.events = EPOLLIN;
+  ev.data.ptr = NULL; // NULL marks the listening socket
+  epoll_ctl(epfd, EPOLL_CTL_ADD, listen_fd, &ev);
+
+  printf("Listening on %s (%d rules loaded)\n", path, grammar.cfg.rule_count);
+  fflush(stdout);
+
+  while (!stop_requested) {
+    int n = epoll_wait(epfd, events, MAX_EVENTS, -1);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("[ERROR] epoll_wait");
+      break;
+    }
+
+    // --- Gather requests from every ready connection into one batch ---
+    int batch_count = 0;
+    int touched_count = 0;
+    for (int i = 0; i < n; ++i) {
+      Connection *conn = events[i].data.ptr;
+      if (conn == NULL) {
+        acceptConnections(epfd, listen_fd, &connection_count);
+        continue;
+      }
+
+      if (events[i].events & EPOLLERR) {
+        conn->dead = 1;
+      } else if (events[i].events & (EPOLLIN | EPOLLHUP)) {
+        readConnection(conn);
+      }
+      extractFrames(&grammar, conn, batch, &batch_count);
+
+      if (!conn->touched) {
+        conn->touched = 1;
+        touched[touched_count++] = conn;
+      }
+    }
+
+    // --- Validate the batch, then send the responses ---
+    runBatch(&grammar, batch, batch_count);
+    for (int i = 0; i < touched_count; ++i) {
+      touched[i]->touched = 0;
+      updateConnection(epfd, touched[i], &connection_count);
+    }
+  }
+
+  close(epfd);
+  close(listen_fd);
+  unlink(path);
+  return 0;
+}
@@ -0,0 +1,606 @@
+// Verifier for leftmost derivations given as sequences of rule indices.
+// Instead of replaying every step on a CFGSymbol array with
+// applyProductionRule() and calling checkDerivation() at the end (O(n^2) array
+// shifting and a strcmp() per step), the verifier keeps a stack of the pending
+// symbols of the sentential form (leftmost symbol on top) and checks the rule
+// sequence against the tokens in one linear pass:
+// - Terminals are matched against the tokens as soon as they become leftmost.
+// - Each rule is checked against the leftmost pending non-terminal, which is
+// the symbol it must be applied to in a leftmost derivation.
+// - Verification stops at the first bad step.
+// Symbols are resolved to integer ids once, so the pass compares ints only.
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_RHS 10     // Maximum number of symbols on the RHS of a production rule
+#define MAX_SYMBOLS 10 // Maximum number of symbols in the CFG
+#define MAX_RULES 10   // Maximum number of rules in the CFG
+#define MAX_THREADS 64 // Maximum number of threads for batches
+#define BATCH_CHUNK 64 // Jobs claimed at once by a batch thread
+
+// Verification status codes
+#define VERIFY_OK 0               // The rules derive exactly the tokens
+#define VERIFY_INVALID_RULE 1     // Rule index is not in 1..rule_count
+#define VERIFY_LHS_MISMATCH 2     // Rule LHS is not the leftmost non-terminal
+#define VERIFY_TOKEN_MISMATCH 3   // A leftmost terminal differs from the token
+#define VERIFY_NO_NONTERMINAL 4   // A rule is left, but no non-terminal is
+#define VERIFY_INCOMPLETE 5       // Non-terminals remain after the last rule
+#define VERIFY_LENGTH_MISMATCH 6  // Pending symbols and tokens left differ
+#define VERIFY_UNKNOWN_TOKEN 7    // A token is not a terminal of the CFG
+#define VERIFY_OUT_OF_MEMORY 8    // The VerifyBuffer could not be grown
+
+typedef struct {
+  // Struct for CFG symbols.
+  // - symbol: Stores symbol as a string (e.g., "true", "false", "AND")
+  // - is_terminal: An int, which indicates whether the symbol is terminal (0 =
+  // false, 1 = true)
+  // - is_start: An int, which indicates whether the symbol is a start symbol (0
+  // = false, 1 = true)
+  char *symbol;
+  int is_terminal;
+  int is_start;
+} CFGSymbol;
+
+// Struct for production rules
+typedef struct {
+  // - lhs: Left-hand side of the production rule (always a non-terminal)
+  // - rhs: Right-hand side of the production rule, with size MAX_RHS.
+  // - rhs_length: Number of symbols on the RHS
+  CFGSymbol lhs;
+  CFGSymbol rhs[MAX_RHS];
+  int rhs_length;
+} CFGProductionRule;
+
+// Struct for CFG
+// - symbols: Array of all CFG symbols,  with size MAX_SYMBOLS.
+// - startSymbol: The start symbol of the CFG
+// - rules: Array of production rules, with size MAX_RULES.
+// - symbol_count: Number of symbols in the CFG
+// - rule_count: Number of rules in the CFG
+typedef struct {
+  CFGSymbol symbols[MAX_SYMBOLS];
+  CFGSymbol startSymbol;
+  CFGProductionRule rules[MAX_RULES];
+  int symbol_count;
+  int rule_count;
+} CFG;
+
+// Struct for a CFG compiled for verification, where every symbol is replaced
+// by its index in cfg->symbols.
+// - cfg: The CFG it was compiled from (used to resolve tokens).
+// - is_terminal: Whether each symbol id is a terminal.
+// - start: Id of the start symbol.
+// - lhs, rhs, rhs_length: The rules, as symbol ids. The RHS is stored
+// reversed, so it can be pushed on the stack in order.
+// - has_empty_rule: Whether some rule has an empty RHS. Without such rules,
+// every pending symbol derives at least one token.
+typedef struct {
+  const CFG *cfg;
+  int is_terminal[MAX_SYMBOLS];
+  int start;
+  int rule_count;
+  int lhs[MAX_RULES];
+  int rhs[MAX_RULES][MAX_RHS];
+  int rhs_length[MAX_RULES];
+  int has_empty_rule;
+} CompiledCFG;
+
+// Struct for the result of a verification.
+// - status: One of the VERIFY_* values.
+// - step: The 0-based index in the rule sequence of the first bad step, or the
+// number of rules if the sequence ended too early.
+// - position: The index of the next unmatched token when verification stopped.
+typedef struct {
+  int status;
+  int step;
+  int position;
+} VerifyResult;
+
+// Struct for the scratch memory of verifyDerivation(), grown as needed and
+// reused across calls. Initialize with {0} and release with freeVerifyBuffer().
+// - token_ids: Token ids, with size token_capacity.
+// - stack: Pending symbols, with size stack_capacity.
+typedef struct {
+  int *token_ids;
+  int token_capacity;
+  int *stack;
+  int stack_capacity;
+} VerifyBuffer;
+
+// Struct for a derivation in a batch.
+// - rules: The 1-based rule indices of the leftmost derivation.
+// - rule_count: Number of rules.
+// - tokens: The tokens the derivation must produce.
+// - token_count: Number of tokens.
+// - result: Filled in by verifyDerivationBatch().
+typedef struct {
+  const int *rules;
+  int rule_count;
+  const CFGSymbol *tokens;
+  int token_count;
+  VerifyResult result;
+} DerivationJob;
+
+// Function prototypes
+int compileCFG(CompiledCFG *compiled, const CFG *cfg);
+VerifyResult verifyDerivation(const CompiledCFG *compiled, const int *rules,
+                              int rule_count, const CFGSymbol *tokens,
+                              int token_count, VerifyBuffer *buffer);
+void freeVerifyBuffer(VerifyBuffer *buffer);
+void verifyDerivationBatch(const CompiledCFG *compiled, DerivationJob *jobs,
+                           int job_count, int thread_count);
+
+// Function to find the id of a symbol, comparing pointers first since symbols
+// usually share the same string literal. Returns -1 if not found.
+int findSymbolId(const CFG *cfg, const CFGSymbol *symbol) {
+  for (int i = 0; i < cfg->symbol_count; ++i) {
+    if (cfg->symbols[i].symbol == symbol->symbol) {
+      return i;
+    }
+  }
+  for (int i = 0; i < cfg->symbol_count; ++i) {
+    if (!strcmp(cfg->symbols[i].symbol, symbol->symbol)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Function to compile a CFG for verification, done once per CFG.
+// Returns 1 on success, or 0 if the symbol or rule count exceeds MAX_SYMBOLS or
+// MAX_RULES, or a rule uses a symbol missing from cfg->symbols, has a terminal
+// LHS, or has an invalid rhs_length (e.g. the -1 set by createProductionRule()
+// for a bad rule).
+int compileCFG(CompiledCFG *compiled, const CFG *cfg) {
+  if (cfg->symbol_count < 0 || cfg->symbol_count > MAX_SYMBOLS) {
+    printf("Invalid symbol count %d.\n", cfg->symbol_count);
+    return 0;
+  }
+  if (cfg->rule_count < 0 || cfg->rule_count > MAX_RULES) {
+    printf("Invalid rule count %d.\n", cfg->rule_count);
+    return 0;
+  }
+  compiled->cfg = cfg;
+  for (int i = 0; i < cfg->symbol_count; ++i) {
+    compiled->is_terminal[i] = cfg->symbols[i].is_terminal;
+  }
+  compiled->start = findSymbolId(cfg, &cfg->startSymbol);
+  if (compiled->start < 0) {
+    printf("Unknown start symbol %s.\n", cfg->startSymbol.symbol);
+    return 0;
+  }
+
+  compiled->rule_count = cfg->rule_count;
+  compiled->has_empty_rule = 0;
+  for (int r = 0; r < cfg->rule_count; ++r) {
+    const CFGProductionRule *rule = &cfg->rules[r];
+    if (rule->rhs_length < 0 || rule->rhs_length > MAX_RHS) {
+      printf("Invalid RHS length %d in rule %d.\n", rule->rhs_length, r + 1);
+      return 0;
+    }
+    compiled->lhs[r] = findSymbolId(cfg, &rule->lhs);
+    compiled->rhs_length[r] = rule->rhs_length;
+    if (compiled->lhs[r] < 0) {
+      printf("Unknown symbol %s in rule %d.\n", rule->lhs.symbol, r + 1);
+      return 0;
+    }
+    if (compiled->is_terminal[compiled->lhs[r]]) {
+      printf("Terminal symbol %s on left-hand side of rule %d.\n",
+             rule->lhs.symbol, r + 1);
+      return 0;
+    }
+    for (int i = 0; i < rule->rhs_length; ++i) {
+      int id = findSymbolId(cfg, &rule->rhs[i]);
+      if (id < 0) {
+        printf("Unknown symbol %s in rule %d.\n", rule->rhs[i].symbol, r + 1);
+        return 0;
+      }
+      compiled->rhs[r][rule->rhs_length - 1 - i] = id;
+    }
+    if (rule->rhs_length == 0) {
+      compiled->has_empty_rule = 1;
+    }
+  }
+  return 1;
+}
+
+// Function to grow an int array to at least size elements.
+// Returns 1 on success, or 0 if out of memory.
+int reserveInts(int **array, int *capacity, long size) {
+  if (size <= *capacity) {
+    return 1;
+  }
+  if (size > INT_MAX) {
+    return 0;
+  }
+  int *grown = realloc(*array, size * sizeof(int));
+  if (grown == NULL) {
+    return 0;
+  }
+  *array = grown;
+  *capacity = size;
+  return 1;
+}
+
+// Function to release the memory of a VerifyBuffer
+void freeVerifyBuffer(VerifyBuffer *buffer) {
+  free(buffer->token_ids);
+  free(buffer->stack);
+  buffer->token_ids = buffer->stack = NULL;
+  buffer->token_capacity = buffer->stack_capacity = 0;
+}
+
+// Function to verify a leftmost derivation against a token sequence.
+// - rules: 1-based rule indices, as used by applyProductionRule().
+// - buffer: Scratch memory, grown to fit the input.
+// - Runs in O(rule_count + token_count) time.
+VerifyResult verifyDerivation(const CompiledCFG *compiled, const int *rules,
+                              int rule_count, const CFGSymbol *tokens,
+                              int token_count, VerifyBuffer *buffer) {
+  VerifyResult result = {VERIFY_OK, 0, 0};
+  int top = 0; // Number of pending symbols
+  int pos = 0; // Index of the next unmatched token
+  int step;
+
+  // Without empty rules, the length check below keeps top <= tokens left, and
+  // a rule adds at most MAX_RHS - 1 symbols before it runs, so the stack never
+  // grows. With empty rules, the stack grows as rules are applied, so a bad
+  // step fails before memory is reserved for the rest of the sequence.
+  long stack_size = compiled->has_empty_rule ? 1 + MAX_RHS
+                                             : (long)token_count + MAX_RHS;
+  if (!reserveInts(&buffer->token_ids, &buffer->token_capacity, token_count) ||
+      !reserveInts(&buffer->stack, &buffer->stack_capacity, stack_size)) {
+    result.status = VERIFY_OUT_OF_MEMORY;
+    return result;
+  }
+  int *token_ids = buffer->token_ids;
+  int *stack = buffer->stack;
+
+  for (int i = 0; i < token_count; ++i) {
+    token_ids[i] = findSymbolId(compiled->cfg, &tokens[i]);
+    if (token_ids[i] < 0 || !compiled->is_terminal[token_ids[i]]) {
+      result.status = VERIFY_UNKNOWN_TOKEN;
+      result.position = i;
+      return result;
+    }
+  }
+
+  stack[top++] = compiled->start;
+  for (step = 0; step <= rule_count; ++step) {
+    // Match the terminals that have become leftmost
+    while (top > 0 && compiled->is_terminal[stack[top - 1]]) {
+      if (pos == token_count || stack[top - 1] != token_ids[pos]) {
+        // The previous step made this terminal leftmost
+        result.status = pos == token_count ? VERIFY_LENGTH_MISMATCH
+                                           : VERIFY_TOKEN_MISMATCH;
+        result.step = step > 0 ? step - 1 : 0;
+        result.position = pos;
+        return result;
+      }
+      --top;
+      ++pos;
+    }
+    if (step == rule_count) {
+      break;
+    }
+
+    // Apply the rule to the leftmost non-terminal
+    // Range-check the raw index first, so INT_MIN cannot overflow
+    if (rules[step] < 1 || rules[step] > compiled->rule_count) {
+      result.status = VERIFY_INVALID_RULE;
+      break;
+    }
+    int r = rules[step] - 1;
+    if (top == 0) {
+      result.status = VERIFY_NO_NONTERMINAL;
+      break;
+    }
+    if (stack[top - 1] != compiled->lhs[r]) {
+      result.status = VERIFY_LHS_MISMATCH;
+      break;
+    }
+    --top;
+    if (top + MAX_RHS > buffer->stack_capacity) {
+      if (!reserveInts(&buffer->stack, &buffer->stack_capacity,
+                       2L * (top + MAX_RHS))) {
+        result.status = VERIFY_OUT_OF_MEMORY;
+        break;
+      }
+      stack = buffer->stack;
+    }
+    memcpy(stack + top, compiled->rhs[r], compiled->rhs_length[r] * sizeof(int));
+    top += compiled->rhs_length[r];
+
+    // Without empty rules, each pending symbol needs at least one token
+    if (!compiled->has_empty_rule && top > token_count - pos) {
+      result.status = VERIFY_LENGTH_MISMATCH;
+      break;
+    }
+  }
+
+  result.step = step;
+  result.position = pos;
+  if (result.status == VERIFY_OK) {
+    if (top > 0) {
+      result.status = VERIFY_INCOMPLETE;
+    } else if (pos != token_count) {
+      result.status = VERIFY_LENGTH_MISMATCH;
+    }
+  }
+  return result;
+}
+
+// Struct for the state shared by the threads of a batch
+typedef struct {
+  const CompiledCFG *compiled;
+  DerivationJob *jobs;
+  int job_count;
+  atomic_int next; // Index of the next unclaimed job
+} BatchState;
+
+// Thread function: claims chunks of BATCH_CHUNK jobs until none are left.
+// Each thread reuses one VerifyBuffer for all its jobs.
+void *verifyBatchWorker(void *arg) {
+  BatchState *state = arg;
+  VerifyBuffer buffer = {0};
+
+  for (;;) {
+    int first = atomic_fetch_add(&state->next, BATCH_CHUNK);
+    if (first >= state->job_count) {
+      freeVerifyBuffer(&buffer);
+      return NULL;
+    }
+    int last = first + BATCH_CHUNK;
+    if (last > state->job_count) {
+      last = state->job_count;
+    }
+    for (int i = first; i < last; ++i) {
+      DerivationJob *job = &state->jobs[i];
+      job->result = verifyDerivation(state->compiled, job->rules,
+                                     job->rule_count, job->tokens,
+                                     job->token_count, &buffer);
+    }
+  }
+}
+
+// Function to verify many derivations in parallel.
+// - thread_count: Number of threads, clamped to 1..MAX_THREADS. The calling
+// thread is one of them.
+void verifyDerivationBatch(const CompiledCFG *compiled, DerivationJob *jobs,
+                           int job_count, int thread_count) {
+  pthread_t threads[MAX_THREADS];
+  BatchState state;
+  int started = 0;
+
+  state.compiled = compiled;
+  state.jobs = jobs;
+  state.job_count = job_count;
+  atomic_init(&state.next, 0);
+
+  if (thread_count > MAX_THREADS) {
+    thread_count = MAX_THREADS;
+  }
+  for (int i = 1; i < thread_count; ++i) {
+    if (pthread_create(&threads[started], NULL, verifyBatchWorker, &state)) {
+      break; // The remaining threads pick up the work
+    }
+    ++started;
+  }
+  verifyBatchWorker(&state);
+  for (int i = 0; i < started; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+}
+
+// Helper function for printing a verification result
+void printVerifyResult(VerifyResult result) {
+  static const char *names[] = {
+      "OK",           "invalid rule",    "LHS mismatch",
+      "token mismatch", "no non-terminal", "incomplete",
+      "length mismatch", "unknown token",  "out of memory"};
+  printf("Result: %s (step %d, token %d)\n", names[result.status], result.step,
+         result.position);
+}
+
+// Main function for testing the verifier
+int main() {
+  printf("==== Test Derivation Verifier ====\n");
+
+  // --- Step 1: Define the Boolean expression CFG ---
+  CFG cfg;
+  CFGSymbol S = {"S", 0, 1}; // start symbol
+  CFGSymbol B = {"B", 0, 0};
+  CFGSymbol T = {"T", 0, 0};
+  CFGSymbol F = {"F", 0, 0};
+  CFGSymbol OR = {"OR", 1, 0};
+  CFGSymbol AND = {"AND", 1, 0};
+  CFGSymbol LP = {"(", 1, 0};
+  CFGSymbol RP = {")", 1, 0};
+  CFGSymbol TRUE = {"true", 1, 0};
+  CFGSymbol FALSE = {"false", 1, 0};
+
+  CFGSymbol symbols[] = {S, B, T, F, OR, AND, LP, RP, TRUE, FALSE};
+  cfg.symbol_count = 10;
+  memcpy(cfg.symbols, symbols, sizeof(symbols));
+  cfg.startSymbol = S;
+
+  CFGProductionRule rules[] = {
+      {S, {B}, 1},         {B, {B, OR, T}, 3}, {B, {T}, 1},
+      {T, {T, AND, F}, 3}, {T, {F}, 1},        {F, {LP, B, RP}, 3},
+      {F, {TRUE}, 1},      {F, {FALSE}, 1}};
+  cfg.rule_count = 8;
+  memcpy(cfg.rules, rules, sizeof(rules));
+
+  CompiledCFG compiled;
+  VerifyBuffer buffer = {0};
+  if (!compileCFG(&compiled, &cfg)) {
+    return 1;
+  }
+
+  // true AND ( false OR true ), see Question 4-A
+  CFGSymbol tokens[] = {TRUE, AND, LP, FALSE, OR, TRUE, RP};
+  int token_count = 7;
+  int derivation[] = {1, 3, 4, 5, 7, 6, 2, 3, 5, 8, 5, 7};
+  int derivation_length = 12;
+
+  // --- Test Case: Valid derivation ---
+  printf("\n[Test] Valid derivation of true AND ( false OR true )\n");
+  printf("Expected: OK (step 12, token 7)\n");
+  printVerifyResult(verifyDerivation(&compiled, derivation, derivation_length,
+                                     tokens, token_count, &buffer));
+
+  // --- Test Case: Rule applied to the wrong non-terminal ---
+  printf("\n[Test] Rule 4 (T -> T AND F) applied to B at step 1\n");
+  int wrong_lhs[] = {1, 4};
+  printf("Expected: LHS mismatch (step 1, token 0)\n");
+  printVerifyResult(verifyDerivation(&compiled, wrong_lhs, 2, tokens,
+                                     token_count, &buffer));
+
+  // --- Test Case: Invalid rule index ---
+  printf("\n[Test] Rule index 9 at step 2\n");
+  int invalid_rule[] = {1, 3, 9};
+  printf("Expected: invalid rule (step 2, token 0)\n");
+  printVerifyResult(verifyDerivation(&compiled, invalid_rule, 3, tokens,
+                                     token_count, &buffer));
+
+  // --- Test Case: Terminal mismatch, detected as soon as it is leftmost ---
+  printf("\n[Test] F -> false instead of F -> true at step 4\n");
+  int wrong_terminal[] = {1, 3, 4, 5, 8, 6, 2, 3, 5, 8, 5, 7};
+  printf("Expected: token mismatch (step 4, token 0)\n");
+  printVerifyResult(verifyDerivation(&compiled, wrong_terminal,
+                                     derivation_length, tokens, token_count,
+                                     &buffer));
+
+  // --- Test Case: Derivation stops early ---
+  printf("\n[Test] Last rule missing\n");
+  printf("Expected: incomplete (step 11, token 5)\n");
+  printVerifyResult(verifyDerivation(&compiled, derivation,
+                                     derivation_length - 1, tokens,
+                                     token_count, &buffer));
+
+  // --- Test Case: Derivation longer than the tokens ---
+  printf("\n[Test] Derivation of true AND ( false OR true ) against true\n");
+  printf("Expected: length mismatch (step 2, token 0)\n");
+  printVerifyResult(verifyDerivation(&compiled, derivation, derivation_length,
+                                     tokens, 1, &buffer));
+
+  // --- Test Case: Long input ---
+  // true OR true OR ... with 600 operands (1199 tokens): rule 1, then rule 2
+  // 599 times, then B -> T -> F -> true and 599 times T -> F -> true.
+  printf("\n[Test] Valid derivation of 600 operands joined by OR\n");
+  static CFGSymbol long_tokens[1199];
+  static int long_derivation[1 + 599 + 3 + 599 * 2];
+  int long_token_count = 0;
+  int long_length = 0;
+  for (int i = 0; i < 600; ++i) {
+    if (i > 0) {
+      long_tokens[long_token_count++] = OR;
+    }
+    long_tokens[long_token_count++] = TRUE;
+  }
+  long_derivation[long_length++] = 1;
+  for (int i = 0; i < 599; ++i) {
+    long_derivation[long_length++] = 2;
+  }
+  long_derivation[long_length++] = 3;
+  long_derivation[long_length++] = 5;
+  long_derivation[long_length++] = 7;
+  for (int i = 0; i < 599; ++i) {
+    long_derivation[long_length++] = 5;
+    long_derivation[long_length++] = 7;
+  }
+  printf("Expected: OK (step 1801, token 1199)\n");
+  printVerifyResult(verifyDerivation(&compiled, long_derivation, long_length,
+                                     long_tokens, long_token_count, &buffer));
+
+  // --- Test Case: Terminal start symbol, no tokens left ---
+  printf("\n[Test] Start symbol true against no tokens\n");
+  CFG terminal_cfg = cfg;
+  CompiledCFG terminal_compiled;
+  terminal_cfg.startSymbol = TRUE;
+  compileCFG(&terminal_compiled, &terminal_cfg);
+  printf("Expected: length mismatch (step 0, token 0)\n");
+  printVerifyResult(
+      verifyDerivation(&terminal_compiled, NULL, 0, tokens, 0, &buffer));
+
+  // --- Test Case: Rejecting invalid rules ---
+  printf("\n[Test] compileCFG() with an invalid rule\n");
+  CFG bad_cfg = cfg;
+  CompiledCFG bad_compiled;
+  bad_cfg.rules[7].rhs_length = -1; // As set by createProductionRule()
+  printf("Expected: Invalid RHS length -1 in rule 8.\nActual  : ");
+  compileCFG(&bad_compiled, &bad_cfg);
+  bad_cfg = cfg;
+  bad_cfg.rules[7].lhs = TRUE;
+  printf("Expected: Terminal symbol true on left-hand side of rule 8.\n");
+  printf("Actual  : ");
+  compileCFG(&bad_compiled, &bad_cfg);
+  bad_cfg = cfg;
+  bad_cfg.rule_count = MAX_RULES + 1;
+  printf("Expected: Invalid rule count 11.\nActual  : ");
+  compileCFG(&bad_compiled, &bad_cfg);
+
+  // --- Test Case: Hostile rule index ---
+  printf("\n[Test] Rule index INT_MIN at step 0\n");
+  int hostile_rule[] = {INT_MIN};
+  printf("Expected: invalid rule (step 0, token 0)\n");
+  printVerifyResult(verifyDerivation(&compiled, hostile_rule, 1, tokens,
+                                     token_count, &buffer));
+
+  // --- Test Case: Fail fast with an empty rule ---
+  // The sequence claims INT_MAX rules, but only the first one is ever read.
+  printf("\n[Test] Bad first rule of a very long sequence, with B -> empty\n");
+  CFG empty_cfg = cfg;
+  CompiledCFG empty_compiled;
+  empty_cfg.rules[8].lhs = B;
+  empty_cfg.rules[8].rhs_length = 0;
+  empty_cfg.rule_count = 9;
+  if (!compileCFG(&empty_compiled, &empty_cfg)) {
+    return 1;
+  }
+  int bad_first_rule[] = {0};
+  printf("Expected: invalid rule (step 0, token 0)\n");
+  printVerifyResult(verifyDerivation(&empty_compiled, bad_first_rule, INT_MAX,
+                                     tokens, token_count, &buffer));
+
+  // --- Test Case: Stack growth with an empty rule ---
+  printf("\n[Test] Valid derivation of 600 operands, with B -> empty\n");
+  freeVerifyBuffer(&buffer);
+  printf("Expected: OK (step 1801, token 1199)\n");
+  printVerifyResult(verifyDerivation(&empty_compiled, long_derivation,
+                                     long_length, long_tokens,
+                                     long_token_count, &buffer));
+  freeVerifyBuffer(&buffer);
+
+  // --- Test Case: Batch verification ---
+  printf("\n[Test] Batch of 100000 derivations on 4 threads\n");
+  static DerivationJob jobs[100000];
+  int job_count = 100000;
+  for (int i = 0; i < job_count; ++i) {
+    jobs[i].rules = i % 2 ? wrong_terminal : derivation;
+    jobs[i].rule_count = derivation_length;
+    jobs[i].tokens = tokens;
+    jobs[i].token_count = token_count;
+  }
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  verifyDerivationBatch(&compiled, jobs, job_count, 4);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  int valid = 0;
+  for (int i = 0; i < job_count; ++i) {
+    valid += jobs[i].result.status == VERIFY_OK;
+  }
+  printf("Expected: 50000 valid\n");
+  printf("Actual  : %d valid in %.3f ms\n", valid,
+         (end.tv_sec - start.tv_sec) * 1e3 +
+             (end.tv_nsec - start.tv_nsec) / 1e6);
+
+  return 0;
+}
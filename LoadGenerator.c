@@ -0,0 +1,290 @@
+// Load generator for the validation daemon (Daemon.c).
+// Opens several connections to the daemon, keeps a fixed number of pipelined
+// requests in flight on each, and reports latency percentiles and throughput.
+// See Daemon.c for the protocol.
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_SOCKET_PATH "/tmp/cfg_daemon.sock"
+#define DEFAULT_CONNECTIONS 4
+#define DEFAULT_REQUESTS 100000 // Requests per connection
+#define DEFAULT_DEPTH 32        // Requests in flight per connection
+#define MAX_CONNECTIONS 256
+#define MAX_DEPTH 1024
+#define HEADER_SIZE 4
+#define RESPONSE_SIZE 8
+#define BUFFER_SIZE (1 << 16)
+#define STATUS_COUNT 4 // Number of response status codes
+
+// Response status codes, see Daemon.c
+#define STATUS_OK 0
+#define STATUS_TOKEN_ERROR 1
+#define STATUS_PARSE_ERROR 2
+
+// Struct for an expression sent by the load generator.
+// - text: The expression.
+// - expected_status: The status the daemon must answer with.
+typedef struct {
+  const char *text;
+  int expected_status;
+} Expression;
+
+// Expressions sent round-robin: valid ones and both kinds of invalid ones
+static const Expression expressions[] = {
+    {"true AND (false OR true)", STATUS_OK},
+    {"true", STATUS_OK},
+    {"(true OR false) AND (false OR (true AND true))", STATUS_OK},
+    {"false OR false OR true AND false", STATUS_OK},
+    {"true AND", STATUS_PARSE_ERROR},
+    {"(true OR false", STATUS_PARSE_ERROR},
+    {"true && false", STATUS_TOKEN_ERROR},
+};
+
+// Struct for a client connection.
+// - send_times: Send timestamps of the in-flight requests, indexed by
+// sequence number modulo depth (responses come back in request order).
+// - sent, received: Number of requests sent and responses received.
+// - in: Partial response bytes.
+typedef struct {
+  int fd;
+  uint64_t send_times[MAX_DEPTH];
+  int sent;
+  int received;
+  unsigned char in[BUFFER_SIZE];
+  int in_length;
+} Client;
+
+// Function to get a monotonic timestamp in nanoseconds
+uint64_t nowNanoseconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// Function to compare latencies for qsort()
+int compareLatencies(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Function to get the p-th percentile of sorted latencies, in microseconds
+double percentile(const uint64_t *sorted, int count, double p) {
+  int index = (int)(p / 100.0 * (count - 1) + 0.5);
+  return sorted[index] / 1000.0;
+}
+
+// Function to connect to the daemon
+int connectDaemon(const char *path) {
+  struct sockaddr_un addr;
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    perror("[ERROR] socket");
+    return -1;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    perror("[ERROR] connect");
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Function to send requests until depth requests are in flight.
+// All frames are written with a single send() (pipelining).
+int fillPipeline(Client *client, int requests, int depth) {
+  unsigned char buffer[BUFFER_SIZE];
+  int length = 0;
+  int count = sizeof(expressions) / sizeof(expressions[0]);
+  int first = client->sent;
+
+  while (client->sent < requests && client->sent - client->received < depth) {
+    const char *expr = expressions[client->sent % count].text;
+    uint32_t n = strlen(expr);
+    if (length + HEADER_SIZE + (int)n > BUFFER_SIZE) {
+      break;
+    }
+    buffer[length] = n >> 24;
+    buffer[length + 1] = n >> 16;
+    buffer[length + 2] = n >> 8;
+    buffer[length + 3] = n;
+    memcpy(buffer + length + HEADER_SIZE, expr, n);
+    length += HEADER_SIZE + n;
+    ++client->sent;
+  }
+
+  uint64_t now = nowNanoseconds();
+  for (int i = first; i < client->sent; ++i) {
+    client->send_times[i % depth] = now;
+  }
+
+  int offset = 0;
+  while (offset < length) {
+    ssize_t n = send(client->fd, buffer + offset, length - offset, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("[ERROR] send");
+      return -1;
+    }
+    offset += n;
+  }
+  return 0;
+}
+
+// Function to read responses, check them and record their latencies.
+// Returns -1 if the connection closed or a response is wrong.
+int readResponses(Client *client, int depth, uint64_t *latencies,
+                  int *latency_count, long *status_counts) {
+  ssize_t n = read(client->fd, client->in + client->in_length,
+                   BUFFER_SIZE - client->in_length);
+  if (n <= 0) {
+    if (n < 0 && errno == EINTR) {
+      return 0;
+    }
+    printf("[ERROR] Connection closed by daemon\n");
+    return -1;
+  }
+  client->in_length += n;
+
+  uint64_t now = nowNanoseconds();
+  int count = sizeof(expressions) / sizeof(expressions[0]);
+  int offset = 0;
+  while (client->in_length - offset >= RESPONSE_SIZE) {
+    const unsigned char *p = client->in + offset;
+    uint32_t length = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                      ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+    int status = p[HEADER_SIZE];
+    const Expression *expr = &expressions[client->received % count];
+    if (length != RESPONSE_SIZE - HEADER_SIZE) {
+      printf("[ERROR] Response %d has length %u, expected %d\n",
+             client->received, length, RESPONSE_SIZE - HEADER_SIZE);
+      return -1;
+    }
+    if (status != expr->expected_status) {
+      printf("[ERROR] Response %d for \"%s\" has status %d, expected %d\n",
+             client->received, expr->text, status, expr->expected_status);
+      return -1;
+    }
+    if (status < STATUS_COUNT) {
+      ++status_counts[status];
+    }
+    latencies[(*latency_count)++] =
+        now - client->send_times[client->received % depth];
+    ++client->received;
+    offset += RESPONSE_SIZE;
+  }
+  memmove(client->in, client->in + offset, client->in_length - offset);
+  client->in_length -= offset;
+  return 0;
+}
+
+// Main function:
+// ./load_generator [socket_path] [connections] [requests_per_connection]
+//                  [pipeline_depth]
+int main(int argc, char **argv) {
+  const char *path = argc > 1 ? argv[1] : DEFAULT_SOCKET_PATH;
+  int connections = argc > 2 ? atoi(argv[2]) : DEFAULT_CONNECTIONS;
+  int requests = argc > 3 ? atoi(argv[3]) : DEFAULT_REQUESTS;
+  int depth = argc > 4 ? atoi(argv[4]) : DEFAULT_DEPTH;
+  struct epoll_event ev, events[MAX_CONNECTIONS];
+  long status_counts[STATUS_COUNT] = {0};
+  int latency_count = 0;
+
+  if (connections < 1 || connections > MAX_CONNECTIONS || requests < 1 ||
+      depth < 1 || depth > MAX_DEPTH) {
+    printf("[ERROR] Usage: %s [socket_path] [connections (1-%d)] "
+           "[requests_per_connection] [pipeline_depth (1-%d)]\n",
+           argv[0], MAX_CONNECTIONS, MAX_DEPTH);
+    return 1;
+  }
+
+  Client *clients = calloc(connections, sizeof(Client));
+  uint64_t *latencies = malloc((size_t)connections * requests * sizeof(uint64_t));
+  int epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (clients == NULL || latencies == NULL || epfd < 0) {
+    printf("[ERROR] Out of resources\n");
+    return 1;
+  }
+
+  for (int i = 0; i < connections; ++i) {
+    clients[i].fd = connectDaemon(path);
+    if (clients[i].fd < 0) {
+      return 1;
+    }
+    ev.events = EPOLLIN;
+    ev.data.ptr = &clients[i];
+    epoll_ctl(epfd, EPOLL_CTL_ADD, clients[i].fd, &ev);
+  }
+
+  printf("Connections: %d, requests per connection: %d, pipeline depth: %d\n",
+         connections, requests, depth);
+
+  uint64_t start = nowNanoseconds();
+  for (int i = 0; i < connections; ++i) {
+    if (fillPipeline(&clients[i], requests, depth) < 0) {
+      return 1;
+    }
+  }
+
+  int done = 0;
+  while (done < connections) {
+    int n = epoll_wait(epfd, events, MAX_CONNECTIONS, -1);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("[ERROR] epoll_wait");
+      return 1;
+    }
+    for (int i = 0; i < n; ++i) {
+      Client *client = events[i].data.ptr;
+      if (readResponses(client, depth, latencies, &latency_count,
+                        status_counts) < 0) {
+        return 1;
+      }
+      if (client->received == requests) {
+        epoll_ctl(epfd, EPOLL_CTL_DEL, client->fd, NULL);
+        ++done;
+      } else if (fillPipeline(client, requests, depth) < 0) {
+        return 1;
+      }
+    }
+  }
+  uint64_t elapsed = nowNanoseconds() - start;
+
+  qsort(latencies, latency_count, sizeof(uint64_t), compareLatencies);
+
+  printf("Requests    : %d in %.3f s\n", latency_count, elapsed / 1e9);
+  printf("Throughput  : %.0f requests/s\n", latency_count / (elapsed / 1e9));
+  printf("Latency p50 : %.1f us\n", percentile(latencies, latency_count, 50));
+  printf("Latency p99 : %.1f us\n", percentile(latencies, latency_count, 99));
+  printf("Latency max : %.1f us\n",
+         latencies[latency_count - 1] / 1000.0);
+  printf("Results     : %ld ok, %ld token errors, %ld parse errors, "
+         "%ld bad frames\n",
+         status_counts[0], status_counts[1], status_counts[2],
+         status_counts[3]);
+
+  for (int i = 0; i < connections; ++i) {
+    close(clients[i].fd);
+  }
+  free(clients);
+  free(latencies);
+  close(epfd);
+  return 0;
+}